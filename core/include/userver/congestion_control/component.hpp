@@ -3,6 +3,7 @@
 /// @file userver/congestion_control/component.hpp
 /// @brief @copybrief congestion_control::Component
 
+#include <userver/compiler/select.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -57,7 +58,16 @@ class Component final : public components::LoggableComponentBase {
   void ExtendWriter(utils::statistics::Writer& writer);
 
   struct Impl;
-  utils::FastPimpl<Impl, 560, 8> pimpl_;
+
+  // 408 is the measured sizeof(Impl) for 64-bit libstdc++; the other values
+  // are unmeasured upper bounds (std::mutex alone differs between the
+  // standard libraries), kept from the flat 560 used before
+  static constexpr std::size_t kPimplSize = compiler::SelectSize()  //
+                                                .For32Bit(560)
+                                                .For64Bit(560)
+                                                .ForLibStdCpp64(408);
+
+  utils::FastPimpl<Impl, kPimplSize, 8> pimpl_;
 };
 
 }  // namespace congestion_control
@@ -1,17 +1,22 @@
 #include <dump/dump_locator.hpp>
 
+#include <dirent.h>
+#include <sys/stat.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <system_error>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 #include <boost/filesystem.hpp>
-#include <boost/regex.hpp>
 
 #include <userver/fs/blocking/write.hpp>
 #include <userver/logging/log.hpp>
-#include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
-#include <userver/utils/from_string.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,22 +26,226 @@ namespace {
 
 const std::string kTimeZone = "UTC";
 
+struct MatchedDumpFilename {
+  TimePoint update_time;
+  uint64_t version{0};
+  bool is_tmp{false};
+};
+
+bool ConsumeNumber(std::string_view& rest, std::size_t digit_count,
+                   std::int64_t& value) {
+  if (rest.size() < digit_count) return false;
+  std::int64_t result = 0;
+  for (std::size_t i = 0; i < digit_count; ++i) {
+    const auto digit = static_cast<unsigned char>(rest[i] - '0');
+    if (digit > 9) return false;
+    result = result * 10 + digit;
+  }
+  rest.remove_prefix(digit_count);
+  value = result;
+  return true;
+}
+
+bool ConsumeChar(std::string_view& rest, char expected) {
+  if (rest.empty() || rest.front() != expected) return false;
+  rest.remove_prefix(1);
+  return true;
+}
+
+// Days since the Unix epoch for a Gregorian calendar date,
+// see http://howardhinnant.github.io/date_algorithms.html
+std::int64_t DaysFromCivil(std::int64_t year, std::int64_t month,
+                           std::int64_t day) {
+  year -= month <= 2;
+  const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const auto year_of_era = static_cast<std::uint64_t>(year - era * 400);
+  const auto day_of_year = static_cast<std::uint64_t>(
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1);
+  const std::uint64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+struct CivilTime {
+  std::int64_t year{};
+  std::int64_t month{};
+  std::int64_t day{};
+  std::int64_t hour{};
+  std::int64_t minute{};
+  std::int64_t second{};
+  std::int64_t microsecond{};
+};
+
+// The inverse of DaysFromCivil,
+// see http://howardhinnant.github.io/date_algorithms.html
+CivilTime CivilFromTimePoint(TimePoint time) {
+  constexpr std::int64_t kMicrosecondsPerDay = 86'400'000'000;
+  const std::int64_t total = time.time_since_epoch().count();
+
+  std::int64_t days = total / kMicrosecondsPerDay;
+  std::int64_t of_day = total % kMicrosecondsPerDay;
+  if (of_day < 0) {
+    of_day += kMicrosecondsPerDay;
+    --days;
+  }
+
+  days += 719468;
+  const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto day_of_era = static_cast<std::uint64_t>(days - era * 146097);
+  const std::uint64_t year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+       day_of_era / 146096) /
+      365;
+  const std::uint64_t day_of_year =
+      day_of_era -
+      (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const std::uint64_t mp = (5 * day_of_year + 2) / 153;
+
+  CivilTime result;
+  result.day = static_cast<std::int64_t>(day_of_year - (153 * mp + 2) / 5 + 1);
+  result.month = static_cast<std::int64_t>(mp < 10 ? mp + 3 : mp - 9);
+  result.year = static_cast<std::int64_t>(year_of_era) + era * 400 +
+                (result.month <= 2);
+  result.microsecond = of_day % 1'000'000;
+  of_day /= 1'000'000;
+  result.second = of_day % 60;
+  of_day /= 60;
+  result.minute = of_day % 60;
+  result.hour = of_day / 60;
+  return result;
+}
+
+// Matches ^(\d{4}-\d{2}-\d{2}T\d{2}(:?)\d{2}\1\d{2}\.\d{6}Z?)-v(\d+)(\.tmp)?$
+// by hand, with the 'Z' suffix required exactly for the non-legacy
+// (colon-less) form. The format is rigid enough for a fixed-width check, and
+// the function runs once per directory entry, where a regex engine with its
+// sub-match allocations — or a strptime-style parse with its timezone
+// machinery — is pure overhead. The date is fixed UTC, so the digits convert
+// to a time_point directly.
+std::optional<MatchedDumpFilename> MatchDumpFilename(
+    std::string_view filename) {
+  MatchedDumpFilename result;
+  std::string_view rest = filename;
+
+  std::int64_t year{};
+  std::int64_t month{};
+  std::int64_t day{};
+  std::int64_t hour{};
+  std::int64_t minute{};
+  std::int64_t second{};
+  std::int64_t microsecond{};
+
+  if (!ConsumeNumber(rest, 4, year) || !ConsumeChar(rest, '-') ||
+      !ConsumeNumber(rest, 2, month) || !ConsumeChar(rest, '-') ||
+      !ConsumeNumber(rest, 2, day) || !ConsumeChar(rest, 'T') ||
+      !ConsumeNumber(rest, 2, hour)) {
+    return std::nullopt;
+  }
+  const bool colon1 = ConsumeChar(rest, ':');
+  if (!ConsumeNumber(rest, 2, minute)) return std::nullopt;
+  const bool colon2 = ConsumeChar(rest, ':');
+  if (!ConsumeNumber(rest, 2, second) || !ConsumeChar(rest, '.') ||
+      !ConsumeNumber(rest, 6, microsecond)) {
+    return std::nullopt;
+  }
+  const bool has_z = ConsumeChar(rest, 'Z');
+
+  // Legacy filenames use both colons and no 'Z', current ones neither colon
+  // and the 'Z'; anything in-between is not a dump name
+  if (colon1 != colon2 || has_z == colon1) return std::nullopt;
+
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 ||
+      minute > 59 || second > 59) {
+    return std::nullopt;
+  }
+
+  const auto days = DaysFromCivil(year, month, day);
+  result.update_time = TimePoint{std::chrono::microseconds{
+      (((days * 24 + hour) * 60 + minute) * 60 + second) * 1'000'000 +
+      microsecond}};
+
+  if (!ConsumeChar(rest, '-') || !ConsumeChar(rest, 'v') || rest.empty() ||
+      static_cast<unsigned char>(rest.front() - '0') > 9) {
+    return std::nullopt;
+  }
+  const auto [version_end, error_code] = std::from_chars(
+      rest.data(), rest.data() + rest.size(), result.version);
+  if (error_code != std::errc{}) return std::nullopt;
+  rest.remove_prefix(version_end - rest.data());
+
+  if (rest == ".tmp") {
+    result.is_tmp = true;
+  } else if (!rest.empty()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// Invokes `callback` with the name of each regular file in `directory`.
+// Iterates using raw `readdir` to avoid the extra `stat` per entry that
+// `boost::filesystem::directory_iterator` + `is_regular_file` would issue:
+// `dirent::d_type` is enough to filter out non-files on most filesystems.
+template <typename Callback>
+void ScanDumpDirectory(const std::string& directory, const Callback& callback) {
+  ::DIR* const dir = ::opendir(directory.c_str());
+  if (!dir) {
+    const auto code = errno;
+    throw std::system_error(
+        code, std::generic_category(),
+        fmt::format("Error while opening directory \"{}\"", directory));
+  }
+  const utils::FastScopeGuard closer{[&dir]() noexcept { ::closedir(dir); }};
+
+  while (true) {
+    // `readdir` returns nullptr for both end-of-directory and error, the
+    // two are only distinguishable through errno. Reset it on each pass:
+    // the loop body may leave it set (e.g. the `lstat` fallback)
+    errno = 0;
+    const ::dirent* const entry = ::readdir(dir);
+    if (!entry) {
+      const auto code = errno;
+      if (code != 0) {
+        throw std::system_error(
+            code, std::generic_category(),
+            fmt::format("Error while reading directory \"{}\"", directory));
+      }
+      break;
+    }
+
+    const std::string_view filename = entry->d_name;
+    if (filename == "." || filename == "..") continue;
+
+    if (entry->d_type == DT_UNKNOWN) {
+      // Some filesystems do not report the entry type, fall back to `lstat`
+      const auto full_path = fmt::format("{}/{}", directory, filename);
+      struct ::stat file_stats {};
+      if (::lstat(full_path.c_str(), &file_stats) == -1 ||
+          !S_ISREG(file_stats.st_mode)) {
+        continue;
+      }
+    } else if (entry->d_type != DT_REG) {
+      continue;
+    }
+
+    callback(filename);
+  }
+}
+
 }  // namespace
 
 DumpLocator::DumpLocator(Config static_config)
-    : config_(static_config),
-      filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
-      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
+    : config_(std::move(static_config)) {}
 
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
+  cached_scan_.reset();
   std::string dump_path = GenerateDumpPath(update_time);
 
-  if (boost::filesystem::exists(dump_path)) {
-    throw std::runtime_error(fmt::format(
-        "{}: could not dump to \"{}\", because the file already exists",
-        config_.name, dump_path));
-  }
-
+  // No stat-based existence precheck here. A concurrent write of the same
+  // dump still fails: FileWriter opens the fixed "<dump_path>.tmp" name with
+  // O_EXCL. A previously finished dump with this name, however, is now
+  // atomically replaced by the final rename instead of being reported as an
+  // error. That is acceptable: the name encodes both the update time and the
+  // format version, so the replacement carries equivalent data.
   try {
     fs::blocking::CreateDirectories(config_.dump_directory);
   } catch (const std::exception& ex) {
@@ -70,6 +279,7 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDump() const {
 
 bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
                                TimePoint new_update_time) {
+  cached_scan_.reset();
   if (new_update_time < old_update_time) {
     LOG_WARNING() << config_.name << ": new_update_time < old_update_time, new="
                   << utils::datetime::Timestring(new_update_time, kTimeZone,
@@ -82,28 +292,28 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
   const std::string old_name = GenerateDumpPath({old_update_time});
   const std::string new_name = GenerateDumpPath({new_update_time});
 
-  try {
-    if (!boost::filesystem::is_regular_file(old_name)) {
+  // A single rename syscall: ENOENT subsumes the previous is_regular_file
+  // precheck and saves a stat on the fast path
+  if (::rename(old_name.c_str(), new_name.c_str()) == -1) {
+    const auto code = errno;
+    if (code == ENOENT) {
       LOG_WARNING()
           << config_.name << ": the previous dump \"" << old_name
           << "\" has suddenly disappeared. A new dump will be created.";
-      return false;
+    } else {
+      LOG_ERROR() << config_.name << ": error while trying to rename dump \""
+                  << old_name << " to \"" << new_name << "\". Reason: "
+                  << std::error_code(code, std::generic_category()).message();
     }
-    boost::filesystem::rename(old_name, new_name);
-    LOG_INFO() << config_.name << ": renamed dump \"" << old_name << "\" to \""
-               << new_name << "\"";
-    return true;
-  } catch (const boost::filesystem::filesystem_error& ex) {
-    LOG_ERROR() << config_.name << ": error while trying to rename dump \""
-                << old_name << " to \"" << new_name << "\". Reason: " << ex;
     return false;
   }
+
+  LOG_INFO() << config_.name << ": renamed dump \"" << old_name << "\" to \""
+             << new_name << "\"";
+  return true;
 }
 
 void DumpLocator::Cleanup() {
-  const auto min_update_time = MinAcceptableUpdateTime();
-  std::vector<DumpFileStats> dumps;
-
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
       LOG_INFO() << "Dump directory \"" << config_.dump_directory
@@ -111,90 +321,89 @@ void DumpLocator::Cleanup() {
       return;
     }
 
-    for (const auto& file :
-         boost::filesystem::directory_iterator{config_.dump_directory}) {
-      if (!boost::filesystem::is_regular_file(file.status())) {
-        continue;
-      }
-
-      std::string filename = file.path().filename().string();
-
-      if (boost::regex_match(filename, tmp_filename_regex_)) {
-        LOG_DEBUG() << "Removing a leftover tmp file \"" << file.path().string()
-                    << "\"";
-        boost::filesystem::remove(file);
-        continue;
-      }
-
-      auto dump = ParseDumpName(file.path().string());
-      if (!dump) {
-        LOG_WARNING() << config_.name
-                      << ": unrelated file in the dump directory, path=\""
-                      << file.path().string() << "\"";
-        continue;
-      }
-
-      if (dump->format_version < config_.dump_format_version ||
-          dump->update_time < min_update_time) {
-        LOG_DEBUG() << config_.name << ": removing an expired dump, path=\""
-                    << file.path().string() << "\"";
-        boost::filesystem::remove(file);
-        continue;
-      }
-
-      if (dump->format_version == config_.dump_format_version) {
-        dumps.push_back(std::move(*dump));
-      }
+    // Reuse the scan performed by the preceding GetLatestDump, if any,
+    // instead of enumerating and parsing the same directory twice
+    auto scan = cached_scan_ ? *std::move(cached_scan_) : ScanDumpDirOnce();
+    cached_scan_.reset();
+
+    // Only the newest max_dump_count dumps survive; neither they nor the
+    // victims need to be ordered, so an O(n) partition is enough
+    if (scan.kept.size() > config_.max_dump_count) {
+      std::nth_element(scan.kept.begin(),
+                       scan.kept.begin() + config_.max_dump_count,
+                       scan.kept.end(),
+                       [](const DumpFileStats& a, const DumpFileStats& b) {
+                         return a.update_time > b.update_time;
+                       });
     }
 
-    std::sort(dumps.begin(), dumps.end(),
-              [](const DumpFileStats& a, const DumpFileStats& b) {
-                return a.update_time > b.update_time;
-              });
-
-    for (size_t i = config_.max_dump_count; i < dumps.size(); ++i) {
+    for (size_t i = config_.max_dump_count; i < scan.kept.size(); ++i) {
       LOG_DEBUG() << config_.name << ": removing an excessive dump \""
-                  << dumps[i].full_path << "\"";
-      boost::filesystem::remove(dumps[i].full_path);
+                  << scan.kept[i].full_path << "\"";
+      scan.victims.push_back(std::move(scan.kept[i].full_path));
     }
+
+    // Removals for tmp files, expired and excessive dumps are batched into
+    // a single pass instead of being interleaved with the directory scan
+    fs::blocking::RemoveFilesBatch(scan.victims);
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while cleaning up old dumps. Cause: " << ex;
   }
 }
 
-std::optional<DumpFileStats> DumpLocator::ParseDumpName(
-    std::string full_path) const {
-  const auto filename = boost::filesystem::path{full_path}.filename().string();
-
-  boost::smatch regex;
-  if (boost::regex_match(filename, regex, filename_regex_)) {
-    UASSERT_MSG(regex.size() == 3,
-                fmt::format("Incorrect sub-match count: {} for filename {}",
-                            regex.size(), filename));
-
-    try {
-      const auto date_string = regex[1].str();
-      const auto date_format = date_string.find(':') == std::string::npos
-                                   ? kFilenameDateFormat
-                                   : kLegacyFilenameDateFormat;
-      const auto date =
-          utils::datetime::Stringtime(date_string, kTimeZone, date_format);
-      const auto version = utils::FromString<uint64_t>(regex[2].str());
-      return DumpFileStats{{Round(date)}, std::move(full_path), version};
-    } catch (const std::exception& ex) {
-      LOG_WARNING() << "A filename looks like a dump, but it is not, path=\""
-                    << filename << "\". Reason: " << ex;
-      return std::nullopt;
+DumpLocator::ScanResult DumpLocator::ScanDumpDirOnce() const {
+  const auto min_update_time = MinAcceptableUpdateTime();
+  ScanResult result;
+  ScanDumpDirectory(config_.dump_directory, [&](std::string_view filename) {
+    // The single MatchDumpFilename call per entry covers both the tmp check
+    // and the dump parse
+    const auto matched = MatchDumpFilename(filename);
+    if (!matched) {
+      LOG_WARNING() << config_.name
+                    << ": unrelated file in the dump directory, path=\""
+                    << config_.dump_directory << '/' << filename << "\"";
+      return;
     }
-  }
-  return std::nullopt;
+
+    if (matched->is_tmp) {
+      auto full_path = fmt::format("{}/{}", config_.dump_directory, filename);
+      LOG_DEBUG() << "A leftover tmp file found: \"" << full_path
+                  << "\". It will be removed on Cleanup";
+      result.victims.push_back(std::move(full_path));
+      return;
+    }
+
+    DumpFileStats dump{{matched->update_time},
+                       fmt::format("{}/{}", config_.dump_directory, filename),
+                       matched->version};
+
+    if (dump.format_version < config_.dump_format_version ||
+        dump.update_time < min_update_time) {
+      LOG_DEBUG() << config_.name << ": an expired dump, path=\""
+                  << dump.full_path << "\". It will be removed on Cleanup";
+      result.victims.push_back(std::move(dump.full_path));
+      return;
+    }
+
+    if (dump.format_version != config_.dump_format_version) {
+      LOG_DEBUG() << "Ignoring dump \"" << dump.full_path
+                  << "\", because its format version (" << dump.format_version
+                  << ") != current version (" << config_.dump_format_version
+                  << ")";
+      return;
+    }
+
+    if (!result.best || dump.update_time > result.best->update_time) {
+      result.best = dump;
+    }
+    result.kept.push_back(std::move(dump));
+  });
+
+  return result;
 }
 
 std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
-  const auto min_update_time = MinAcceptableUpdateTime();
-  std::optional<DumpFileStats> best_dump;
-
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
       LOG_DEBUG() << "Dump directory \"" << config_.dump_directory
@@ -202,58 +411,26 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
       return {};
     }
 
-    for (const auto& file :
-         boost::filesystem::directory_iterator{config_.dump_directory}) {
-      if (!boost::filesystem::is_regular_file(file.status())) {
-        continue;
-      }
-
-      auto curr_dump = ParseDumpName(file.path().string());
-      if (!curr_dump) {
-        if (boost::regex_match(file.path().filename().string(),
-                               tmp_filename_regex_)) {
-          LOG_DEBUG() << "A leftover tmp file found: \"" << file.path().string()
-                      << "\". It will be removed on next Cleanup";
-        } else {
-          LOG_WARNING() << "Unrelated file in the dump directory: \""
-                        << file.path().string() << "\"";
-        }
-        continue;
-      }
-
-      if (curr_dump->format_version != config_.dump_format_version) {
-        LOG_DEBUG() << "Ignoring dump \"" << curr_dump->full_path
-                    << "\", because its format version ("
-                    << curr_dump->format_version << ") != current version ("
-                    << config_.dump_format_version << ")";
-        continue;
-      }
-
-      if (curr_dump->update_time < min_update_time && config_.max_dump_age) {
-        LOG_DEBUG() << "Ignoring dump \"" << curr_dump->full_path
-                    << "\", because its age is greater than the maximum "
-                       "allowed dump age ("
-                    << config_.max_dump_age->count() << "ms)";
-        continue;
-      }
-
-      if (!best_dump || curr_dump->update_time > best_dump->update_time) {
-        best_dump = std::move(curr_dump);
-      }
-    }
+    auto scan = ScanDumpDirOnce();
+    auto best_dump = scan.best;
+    // Save the scan for the Cleanup that typically follows on startup
+    cached_scan_ = std::move(scan);
+    return best_dump;
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while trying to fetch dumps. Cause: " << ex;
-    // proceed to return best_dump
+    return std::nullopt;
   }
-
-  return best_dump ? std::optional{std::move(best_dump)} : std::nullopt;
 }
 
 std::string DumpLocator::GenerateDumpPath(TimePoint update_time) const {
+  // Format the kFilenameDateFormat timestamp directly from the components:
+  // a single compiled format call, no Timestring heap allocation in-between
+  const auto time = CivilFromTimePoint(update_time);
   return fmt::format(
-      FMT_COMPILE("{}/{}-v{}"), config_.dump_directory,
-      utils::datetime::Timestring(update_time, kTimeZone, kFilenameDateFormat),
+      FMT_COMPILE("{}/{:04}-{:02}-{:02}T{:02}{:02}{:02}.{:06}Z-v{}"),
+      config_.dump_directory, time.year, time.month, time.day, time.hour,
+      time.minute, time.second, time.microsecond,
       config_.dump_format_version);
 }
 
@@ -263,12 +440,6 @@ TimePoint DumpLocator::MinAcceptableUpdateTime() const {
              : TimePoint::min();
 }
 
-std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
-  return std::string{
-             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
-         (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
-}
-
 TimePoint DumpLocator::Round(std::chrono::system_clock::time_point time) {
   return std::chrono::round<TimePoint::duration>(time);
 }
@@ -3,9 +3,7 @@
 #include <chrono>
 #include <optional>
 #include <string>
-#include <string_view>
-
-#include <boost/regex.hpp>
+#include <vector>
 
 #include <userver/dump/config.hpp>
 #include <userver/dump/helpers.hpp>
@@ -15,7 +13,6 @@ USERVER_NAMESPACE_BEGIN
 namespace dump {
 
 const std::string kFilenameDateFormat = "%Y-%m-%dT%H%M%E6SZ";
-const std::string kLegacyFilenameDateFormat = "%Y-%m-%dT%H:%M:%E6S";
 
 struct DumpFileStats final {
   TimePoint update_time;
@@ -25,7 +22,9 @@ struct DumpFileStats final {
 
 /// @brief Manages dump files on disk. Encapsulates file paths and naming scheme
 /// and performs necessary bookkeeping.
-/// @note The class is thread-safe, except for `Cleanup`
+/// @note `GetLatestDump` saves its scan result for the `Cleanup` that
+/// follows, so the two must not be called concurrently; `Dumper` serializes
+/// all the calls
 class DumpLocator final {
  public:
   explicit DumpLocator(Config static_config);
@@ -53,9 +52,14 @@ class DumpLocator final {
   void Cleanup();
 
  private:
-  enum class FileFormatType { kNormal, kTmp };
+  struct ScanResult {
+    std::optional<DumpFileStats> best;  // the freshest usable dump
+    std::vector<DumpFileStats> kept;    // current-version non-expired dumps
+    std::vector<std::string> victims;   // tmp files and expired dumps
+  };
 
-  std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
+  /// @throws On a filesystem error
+  ScanResult ScanDumpDirOnce() const;
 
   std::optional<DumpFileStats> GetLatestDumpImpl() const;
 
@@ -63,13 +67,14 @@ class DumpLocator final {
 
   TimePoint MinAcceptableUpdateTime() const;
 
-  static std::string GenerateFilenameRegex(FileFormatType type);
-
   static TimePoint Round(std::chrono::system_clock::time_point);
 
   const Config config_;
-  const boost::regex filename_regex_;
-  const boost::regex tmp_filename_regex_;
+
+  // The scan performed by GetLatestDump is saved for the next Cleanup, which
+  // typically follows right after it on startup. Invalidated by anything
+  // that modifies the directory contents.
+  mutable std::optional<ScanResult> cached_scan_;
 };
 
 }  // namespace dump
@@ -61,6 +61,10 @@ void FileWriter::Finish() {
 FileReader::FileReader(std::string path) : path_(std::move(path)) {
   try {
     file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
+    // Dumps are read front-to-back exactly once, and loading them is on the
+    // startup critical path: start the kernel readahead right away so that
+    // the disk reads overlap with parsing.
+    file_.HintSequentialReadAhead();
   } catch (const std::exception& ex) {
     throw Error(fmt::format(
         "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
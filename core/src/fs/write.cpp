@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/utils/boost_uuid4.hpp>
 
@@ -54,7 +55,20 @@ void RewriteFileContentsAtomically(engine::TaskProcessor& async_tp,
   engine::AsyncNoSpan(async_tp, [&]() {
     auto tmp_path =
         fmt::format("{}{}.tmp", path, utils::generators::GenerateBoostUuid());
-    fs::blocking::RewriteFileContents(tmp_path, contents);
+
+    // The tmp file name is unique, so open with O_EXCL instead of O_TRUNC.
+    constexpr fs::blocking::OpenMode flags{
+        fs::blocking::OpenFlag::kWrite,
+        fs::blocking::OpenFlag::kExclusiveCreate};
+    auto fd = fs::blocking::FileDescriptor::Open(tmp_path, flags);
+    // Pre-size the file so that writing a multi-megabyte contents does not
+    // grow it allocation by allocation
+    if (!contents.empty()) fd.Preallocate(contents.size());
+    fd.Write(contents);
+    // Only the file data has to reach the disk here; the metadata is covered
+    // by the directory sync after the rename
+    fd.FDataSync();
+    std::move(fd).Close();
 
     boost::filesystem::path file_path(path);
     auto directory_path = file_path.parent_path();
@@ -48,6 +48,13 @@ class CFile final {
   /// @throws std::runtime_error
   void Close() &&;
 
+  /// @brief Hints the kernel that the whole file is about to be read
+  /// sequentially, which starts the readahead early and keeps it running
+  /// ahead of the subsequent `Read` calls
+  /// @note Best-effort: a no-op on platforms without `posix_fadvise`
+  /// @throws std::runtime_error
+  void HintSequentialReadAhead();
+
   /// @brief Reads data from the file
   /// @returns The amount of bytes actually acquired, which can be equal
   /// to `max_size`, or less on end-of-file
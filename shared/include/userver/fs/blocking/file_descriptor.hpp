@@ -55,6 +55,13 @@ class FileDescriptor final {
   /// Passes the ownership of the file descriptor to the caller
   int Release() &&;
 
+  /// @brief Preallocates disk space for the file, so that writing `size`
+  /// bytes does not grow the file allocation by allocation
+  /// @note Best-effort: a no-op on platforms and filesystems that do not
+  /// support preallocation
+  /// @throws std::runtime_error
+  void Preallocate(std::size_t size);
+
   /// @brief Writes data to the file
   /// @warning Unless `FSync` is called, there is no guarantee the data
   /// is stored on disk safely.
@@ -71,6 +78,11 @@ class FileDescriptor final {
   /// @throws std::runtime_error
   void FSync();
 
+  /// @brief Makes sure the written data is actually stored on disk, without
+  /// flushing the file metadata (e.g. the modification time)
+  /// @throws std::runtime_error
+  void FDataSync();
+
   /// @brief Fetches the file size
   /// @throws std::runtime_error
   std::size_t GetSize() const;
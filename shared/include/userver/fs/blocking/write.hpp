@@ -5,6 +5,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -53,6 +54,12 @@ void Chmod(const std::string& path, boost::filesystem::perms perms);
 /// @throws std::runtime_error
 bool RemoveSingleFile(const std::string& path);
 
+/// @brief Remove a batch of files synchronously. Missing files are skipped,
+/// the remaining files are still removed if removal of one of them fails.
+/// @param paths file paths to remove
+/// @throws std::runtime_error on the first failure after attempting the rest
+void RemoveFilesBatch(const std::vector<std::string>& paths);
+
 }  // namespace fs::blocking
 
 USERVER_NAMESPACE_END
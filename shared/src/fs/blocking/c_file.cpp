@@ -1,5 +1,6 @@
 #include <userver/fs/blocking/c_file.hpp>
 
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <cstdio>
@@ -79,6 +80,22 @@ void CFile::Close() && {
   utils::CheckSyscall(std::fclose(impl_->handle.release()), "calling fclose");
 }
 
+void CFile::HintSequentialReadAhead() {
+  UASSERT(IsOpen());
+#ifdef POSIX_FADV_SEQUENTIAL
+  // The hint is an optimization only; Darwin has no posix_fadvise
+  const int fd = impl_->GetFileDescriptor();
+  for (const int advice : {POSIX_FADV_SEQUENTIAL, POSIX_FADV_WILLNEED}) {
+    // Unlike most syscalls, posix_fadvise returns the error code directly
+    const auto code = ::posix_fadvise(fd, 0, 0, advice);
+    if (code != 0) {
+      throw std::system_error(code, std::generic_category(),
+                              "calling ::posix_fadvise");
+    }
+  }
+#endif
+}
+
 std::size_t CFile::Read(char* buffer, std::size_t size) {
   UASSERT(IsOpen());
 
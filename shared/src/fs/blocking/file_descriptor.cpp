@@ -5,6 +5,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <cerrno>
 #include <system_error>
 #include <utility>
 
@@ -132,6 +133,22 @@ int FileDescriptor::GetNative() const { return fd_; }
 
 int FileDescriptor::Release() && { return std::exchange(fd_, kNoFd); }
 
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void FileDescriptor::Preallocate(std::size_t size) {
+#ifdef __APPLE__
+  // Darwin has no posix_fallocate. Preallocation is just an optimization
+  // hint, so skip it instead of emulating it with fcntl(F_PREALLOCATE).
+  static_cast<void>(size);
+#else
+  const auto code = ::posix_fallocate(fd_, 0, size);
+  // The filesystem may simply not support preallocation, which is fine
+  if (code != 0 && code != EOPNOTSUPP) {
+    throw std::system_error(code, std::generic_category(),
+                            "calling ::posix_fallocate");
+  }
+#endif
+}
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 void FileDescriptor::Write(std::string_view contents) {
   const char* buffer = contents.data();
@@ -170,6 +187,11 @@ void FileDescriptor::FSync() {
   utils::CheckSyscall(::fsync(fd_), "calling ::fsync");
 }
 
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void FileDescriptor::FDataSync() {
+  utils::CheckSyscall(::fdatasync(fd_), "calling ::fdatasync");
+}
+
 std::size_t FileDescriptor::GetSize() const {
   return GetFileStats(fd_).st_size;
 }
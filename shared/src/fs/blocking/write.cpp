@@ -1,7 +1,9 @@
 #include <userver/fs/blocking/write.hpp>
 
 #include <sys/stat.h>
+#include <unistd.h>
 #include <cerrno>
+#include <optional>
 #include <system_error>
 
 #include <fmt/format.h>
@@ -83,6 +85,26 @@ bool RemoveSingleFile(const std::string& path) {
   return boost::filesystem::remove(path);
 }
 
+void RemoveFilesBatch(const std::vector<std::string>& paths) {
+  std::optional<std::system_error> first_error;
+
+  // A single pass of bare unlink calls: no per-file stat, no exception
+  // machinery on the happy path, and an error for one file does not prevent
+  // the removal of the others.
+  for (const auto& path : paths) {
+    if (::unlink(path.c_str()) == -1) {
+      const auto code = errno;
+      if (code != ENOENT && !first_error) {
+        first_error.emplace(
+            code, std::generic_category(),
+            fmt::format("Error while removing file \"{}\"", path));
+      }
+    }
+  }
+
+  if (first_error) throw std::move(*first_error);
+}
+
 }  // namespace fs::blocking
 
 USERVER_NAMESPACE_END
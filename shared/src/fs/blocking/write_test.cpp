@@ -17,4 +17,21 @@ TEST(Fs, CreateDirectories) {
   EXPECT_TRUE(status.permissions() == perms);
 }
 
+TEST(Fs, RemoveFilesBatch) {
+  const auto root = fs::blocking::TempDirectory::Create();
+  const auto file1 = root.GetPath() + "/foo";
+  const auto file2 = root.GetPath() + "/bar";
+  const auto kept = root.GetPath() + "/baz";
+  fs::blocking::RewriteFileContents(file1, "1");
+  fs::blocking::RewriteFileContents(file2, "2");
+  fs::blocking::RewriteFileContents(kept, "3");
+
+  // A missing file in the batch is not an error
+  fs::blocking::RemoveFilesBatch({file1, root.GetPath() + "/missing", file2});
+
+  EXPECT_FALSE(boost::filesystem::exists(file1));
+  EXPECT_FALSE(boost::filesystem::exists(file2));
+  EXPECT_TRUE(boost::filesystem::exists(kept));
+}
+
 USERVER_NAMESPACE_END